@@ -0,0 +1,418 @@
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "config_image.h"
+#include "../logging.h"
+
+#define CONFIG_IMAGE_MAGIC "EMCONF\0\0"
+#define CONFIG_IMAGE_ALIGN 16
+
+// Sezione dell'immagine: scostamento dall'inizio e numero di elementi (byte per le stringhe)
+typedef struct config_image_section_t {
+    uint64_t offset;
+    uint64_t count;
+} config_image_section_t;
+
+typedef struct config_image_env_t {
+    int32_t height;
+    int32_t width;
+    int32_t dispatch_mode;
+    int32_t dispatch_window_ms;
+    int32_t dispatch_batch_max;
+    int32_t journal_sync_ms;
+    uint64_t queue;                     // Scostamenti nella sezione delle stringhe (0 = NULL)
+    uint64_t metrics_socket;
+    uint64_t journal;
+} config_image_env_t;
+
+// Intestazione su disco. Le dimensioni delle struct fanno parte del formato: un'immagine prodotta da una
+// build con una disposizione diversa viene rifiutata invece di essere letta in modo sbagliato
+typedef struct config_image_header_t {
+    char magic[8];
+    uint32_t version;
+    uint32_t pointer_size;
+    uint32_t rescuer_type_size;
+    uint32_t twin_size;
+    uint32_t emergency_type_size;
+    uint32_t request_size;
+    uint64_t image_size;
+    config_image_source_t sources[CONFIG_IMAGE_SOURCES];   // environment, rescuers, emergencies
+    config_image_section_t rescuer_types;                  // count elementi + terminatore
+    config_image_section_t twins;
+    config_image_section_t emergency_types;
+    config_image_section_t requests;
+    config_image_section_t strings;
+    config_image_env_t env;
+} config_image_header_t;
+
+static void header_layout_init(config_image_header_t* header) {
+    memcpy(header->magic, CONFIG_IMAGE_MAGIC, sizeof(header->magic));
+    header->version = CONFIG_IMAGE_VERSION;
+    header->pointer_size = (uint32_t)sizeof(void*);
+    header->rescuer_type_size = (uint32_t)sizeof(rescuer_type_t);
+    header->twin_size = (uint32_t)sizeof(rescuer_digital_twin_t);
+    header->emergency_type_size = (uint32_t)sizeof(emergency_type_t);
+    header->request_size = (uint32_t)sizeof(rescuer_request_t);
+}
+
+static size_t align_up(size_t value) {
+    return (value + CONFIG_IMAGE_ALIGN - 1) & ~(size_t)(CONFIG_IMAGE_ALIGN - 1);
+}
+
+// Scostamento salvato in un campo puntatore (e viceversa durante la rilocazione)
+#define IMAGE_OFFSET(ptr) ((uint64_t)(uintptr_t)(ptr))
+#define IMAGE_POINTER(type, offset) ((type)(uintptr_t)(offset))
+
+static const char* source_path(const config_paths_t* paths, size_t index) {
+    if (index == 0) return paths->environment;
+    if (index == 1) return paths->rescuers;
+    return paths->emergencies;
+}
+
+int config_image_stamp(const config_paths_t* paths, config_image_source_t stamps[CONFIG_IMAGE_SOURCES]) {
+    if (!paths || !stamps) return -1;
+    for (size_t i = 0; i < CONFIG_IMAGE_SOURCES; i++) {
+        struct stat info;
+        const char* path = source_path(paths, i);
+        if (!path || stat(path, &info) != 0) {
+            LOG_WARN(FILE_PARSING, "CONFIG-IMAGE", "Impossibile leggere '%s': %s", path ? path : "(null)", strerror(errno));
+            return -1;
+        }
+        stamps[i].size = (int64_t)info.st_size;
+        stamps[i].mtime_sec = (int64_t)info.st_mtim.tv_sec;
+        stamps[i].mtime_nsec = (int64_t)info.st_mtim.tv_nsec;
+    }
+    return 0;
+}
+
+/*
+* ---------------------------------------------------------------------------------------------------
+*                                           Scrittura
+* ---------------------------------------------------------------------------------------------------
+*/
+
+// Accoda una stringa alla sezione delle stringhe; restituisce il suo scostamento nell'immagine (0 = NULL)
+static uint64_t put_string(char* image, const config_image_header_t* header, size_t* used, const char* value) {
+    if (!value) return 0;
+    size_t length = strlen(value) + 1;
+    uint64_t offset = header->strings.offset + *used;
+    memcpy(image + offset, value, length);
+    *used += length;
+    return offset;
+}
+
+static size_t string_size(const char* value) {
+    return value ? strlen(value) + 1 : 0;
+}
+
+int config_image_write(const char* image_path, const config_image_source_t stamps[CONFIG_IMAGE_SOURCES],
+                       const environment_variable_t* env_vars, const rescuer_type_t* rescuer_types,
+                       const rescuer_digital_twin_t* rescuer_twins, size_t rescuer_twins_count,
+                       const emergency_type_t* emergency_types, size_t emergency_types_count) {
+    if (!image_path || !stamps || !env_vars || !rescuer_types || (!rescuer_twins && rescuer_twins_count > 0) ||
+        (!emergency_types && emergency_types_count > 0)) {
+        return -1;
+    }
+
+    // Dimensioni delle sezioni
+    size_t types_count = 0;
+    size_t strings_size = 1; // Il primo byte resta vuoto: nessuna stringa ha scostamento relativo 0
+    while (rescuer_types[types_count].rescuer_type_name) {
+        strings_size += string_size(rescuer_types[types_count].rescuer_type_name);
+        types_count++;
+    }
+    size_t requests_count = 0;
+    for (size_t i = 0; i < emergency_types_count; i++) {
+        strings_size += string_size(emergency_types[i].emergency_name);
+        if (emergency_types[i].rescuer_requests) requests_count += (size_t)emergency_types[i].rescuers_req_number;
+    }
+    strings_size += string_size(env_vars->queue) + string_size(env_vars->metrics_socket) + string_size(env_vars->journal);
+
+    config_image_header_t header = { 0 };
+    header_layout_init(&header);
+    memcpy(header.sources, stamps, sizeof(header.sources));
+    size_t offset = align_up(sizeof(header));
+    header.rescuer_types = (config_image_section_t){ offset, types_count };
+    offset = align_up(offset + (types_count + 1) * sizeof(rescuer_type_t));
+    header.twins = (config_image_section_t){ offset, rescuer_twins_count };
+    offset = align_up(offset + (rescuer_twins_count + 1) * sizeof(rescuer_digital_twin_t));
+    header.emergency_types = (config_image_section_t){ offset, emergency_types_count };
+    offset = align_up(offset + (emergency_types_count + 1) * sizeof(emergency_type_t));
+    header.requests = (config_image_section_t){ offset, requests_count };
+    offset = align_up(offset + requests_count * sizeof(rescuer_request_t));
+    header.strings = (config_image_section_t){ offset, strings_size };
+    header.image_size = offset + strings_size;
+
+    char* image = calloc(1, header.image_size); // Azzera anche terminatori e campi di esecuzione dei gemelli
+    if (!image) {
+        LOG_ERROR(FILE_PARSING, "CONFIG-IMAGE", "Errore di allocazione per un'immagine di %llu byte", (unsigned long long)header.image_size);
+        return -1;
+    }
+    size_t strings_used = 1;
+
+    rescuer_type_t* types_out = (rescuer_type_t*)(image + header.rescuer_types.offset);
+    for (size_t t = 0; t < types_count; t++) {
+        types_out[t] = rescuer_types[t];
+        types_out[t].rescuer_type_name = IMAGE_POINTER(char*, put_string(image, &header, &strings_used, rescuer_types[t].rescuer_type_name));
+    }
+
+    rescuer_digital_twin_t* twins_out = (rescuer_digital_twin_t*)(image + header.twins.offset);
+    for (size_t i = 0; i < rescuer_twins_count; i++) {
+        const rescuer_digital_twin_t* twin = &rescuer_twins[i];
+        twins_out[i].id = twin->id;
+        twins_out[i].x = twin->x;
+        twins_out[i].y = twin->y;
+        twins_out[i].status = twin->status;
+        // Ogni gemello punta alla riga da cui è nato (righe con lo stesso nome restano distinte)
+        size_t type_index = (size_t)(twin->type - rescuer_types);
+        twins_out[i].type = IMAGE_POINTER(rescuer_type_t*, header.rescuer_types.offset + type_index * sizeof(rescuer_type_t));
+    }
+
+    emergency_type_t* emergencies_out = (emergency_type_t*)(image + header.emergency_types.offset);
+    rescuer_request_t* requests_out = (rescuer_request_t*)(image + header.requests.offset);
+    size_t request_index = 0;
+    for (size_t i = 0; i < emergency_types_count; i++) {
+        const emergency_type_t* type = &emergency_types[i];
+        emergencies_out[i].priority = type->priority;
+        emergencies_out[i].emergency_name = IMAGE_POINTER(char*, put_string(image, &header, &strings_used, type->emergency_name));
+        emergencies_out[i].rescuers_req_number = type->rescuers_req_number;
+        if (!type->rescuer_requests || type->rescuers_req_number <= 0) continue;
+        emergencies_out[i].rescuer_requests = IMAGE_POINTER(rescuer_request_t*, header.requests.offset + request_index * sizeof(rescuer_request_t));
+        for (int r = 0; r < type->rescuers_req_number; r++, request_index++) {
+            const rescuer_request_t* request = &type->rescuer_requests[r];
+            requests_out[request_index].required_count = request->required_count;
+            requests_out[request_index].time_to_manage = request->time_to_manage;
+            if (request->type) { // Un tipo sconosciuto resta NULL come nel parser
+                size_t type_index = (size_t)(request->type - rescuer_types);
+                requests_out[request_index].type = IMAGE_POINTER(rescuer_type_t*, header.rescuer_types.offset + type_index * sizeof(rescuer_type_t));
+            }
+        }
+    }
+
+    header.env = (config_image_env_t){
+        .height = env_vars->height,
+        .width = env_vars->width,
+        .dispatch_mode = (int32_t)env_vars->dispatch_mode,
+        .dispatch_window_ms = env_vars->dispatch_window_ms,
+        .dispatch_batch_max = env_vars->dispatch_batch_max,
+        .journal_sync_ms = env_vars->journal_sync_ms,
+        .queue = put_string(image, &header, &strings_used, env_vars->queue),
+        .metrics_socket = put_string(image, &header, &strings_used, env_vars->metrics_socket),
+        .journal = put_string(image, &header, &strings_used, env_vars->journal),
+    };
+    memcpy(image, &header, sizeof(header));
+
+    // Scrittura atomica: il server legge la vecchia immagine o quella nuova completa
+    size_t tmp_length = strlen(image_path) + 5;
+    char* tmp_path = malloc(tmp_length);
+    if (!tmp_path) {
+        free(image);
+        return -1;
+    }
+    snprintf(tmp_path, tmp_length, "%s.tmp", image_path);
+    int result = -1;
+    FILE* file = fopen(tmp_path, "wb");
+    if (file) {
+        bool written = fwrite(image, 1, header.image_size, file) == header.image_size;
+        if (fclose(file) == 0 && written && rename(tmp_path, image_path) == 0) {
+            result = 0;
+        }
+    }
+    if (result != 0) {
+        LOG_ERROR(FILE_PARSING, "CONFIG-IMAGE", "Errore nella scrittura dell'immagine '%s': %s", image_path, strerror(errno));
+        unlink(tmp_path);
+    }
+    free(tmp_path);
+    free(image);
+    return result;
+}
+
+/*
+* ---------------------------------------------------------------------------------------------------
+*                                     Caricamento e rilocazione
+* ---------------------------------------------------------------------------------------------------
+*/
+
+static bool section_fits(const config_image_section_t* section, size_t element_size, size_t extra, uint64_t image_size) {
+    if (section->offset % CONFIG_IMAGE_ALIGN != 0 || section->offset > image_size) return false;
+    if (section->count > (image_size - section->offset) / element_size) return false;
+    return (section->count + extra) * element_size <= image_size - section->offset;
+}
+
+// Riloca un campo che punta a una stringa; 0 resta NULL
+static bool relocate_string(char* base, const config_image_header_t* header, char** field) {
+    uint64_t offset = IMAGE_OFFSET(*field);
+    if (offset == 0) return true;
+    if (offset <= header->strings.offset || offset >= header->strings.offset + header->strings.count) return false;
+    *field = base + offset;
+    return true;
+}
+
+// Riloca un campo che punta a un tipo di soccorritore: deve cadere all'inizio di un elemento
+static bool relocate_rescuer_type(char* base, const config_image_header_t* header, rescuer_type_t** field) {
+    uint64_t offset = IMAGE_OFFSET(*field);
+    if (offset == 0) return true;
+    if (offset < header->rescuer_types.offset) return false;
+    uint64_t relative = offset - header->rescuer_types.offset;
+    if (relative % sizeof(rescuer_type_t) != 0 || relative / sizeof(rescuer_type_t) >= header->rescuer_types.count) return false;
+    *field = (rescuer_type_t*)(base + offset);
+    return true;
+}
+
+static bool image_relocate(char* base, const config_image_header_t* header) {
+    rescuer_type_t* types = (rescuer_type_t*)(base + header->rescuer_types.offset);
+    for (size_t t = 0; t < header->rescuer_types.count; t++) {
+        if (!types[t].rescuer_type_name || !relocate_string(base, header, &types[t].rescuer_type_name)) return false;
+    }
+    if (types[header->rescuer_types.count].rescuer_type_name) return false; // Terminatore
+
+    rescuer_digital_twin_t* twins = (rescuer_digital_twin_t*)(base + header->twins.offset);
+    for (size_t i = 0; i < header->twins.count; i++) {
+        if (!twins[i].type || !relocate_rescuer_type(base, header, &twins[i].type)) return false;
+    }
+
+    emergency_type_t* emergencies = (emergency_type_t*)(base + header->emergency_types.offset);
+    uint64_t requests_end = header->requests.offset + header->requests.count * sizeof(rescuer_request_t);
+    for (size_t i = 0; i < header->emergency_types.count; i++) {
+        emergency_type_t* type = &emergencies[i];
+        if (!type->emergency_name || !relocate_string(base, header, &type->emergency_name)) return false;
+        uint64_t offset = IMAGE_OFFSET(type->rescuer_requests);
+        if (offset == 0) continue;
+        if (type->rescuers_req_number <= 0 || offset < header->requests.offset ||
+            (offset - header->requests.offset) % sizeof(rescuer_request_t) != 0 ||
+            offset + (uint64_t)type->rescuers_req_number * sizeof(rescuer_request_t) > requests_end) {
+            return false;
+        }
+        type->rescuer_requests = (rescuer_request_t*)(base + offset);
+    }
+    if (emergencies[header->emergency_types.count].emergency_name) return false;
+
+    rescuer_request_t* requests = (rescuer_request_t*)(base + header->requests.offset);
+    for (size_t r = 0; r < header->requests.count; r++) {
+        if (!relocate_rescuer_type(base, header, &requests[r].type)) return false;
+    }
+    return true;
+}
+
+int config_image_load(config_image_t* image, const char* image_path, const config_paths_t* paths) {
+    if (!image || !paths) return -1;
+    *image = (config_image_t){ 0 };
+    if (!image_path) image_path = CONFIG_IMAGE_DEFAULT_PATH;
+
+    int fd = open(image_path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        LOG_FILE_PARSING("CONFIG-IMAGE", "Immagine '%s' non disponibile: %s", image_path, strerror(errno));
+        return -1;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(config_image_header_t)) {
+        LOG_WARN(FILE_PARSING, "CONFIG-IMAGE", "Immagine '%s' troncata o illeggibile", image_path);
+        close(fd);
+        return -1;
+    }
+
+    // Mappatura privata: la rilocazione e le modifiche del server ai gemelli non toccano il file
+    size_t size = (size_t)info.st_size;
+    char* base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        LOG_WARN(FILE_PARSING, "CONFIG-IMAGE", "Errore nella mappatura di '%s': %s", image_path, strerror(errno));
+        return -1;
+    }
+
+    config_image_header_t header;
+    memcpy(&header, base, sizeof(header));
+    config_image_header_t expected = { 0 };
+    header_layout_init(&expected);
+    const char* reason = NULL;
+    if (memcmp(&header, &expected, offsetof(config_image_header_t, image_size)) != 0) {
+        reason = "versione o disposizione delle struct diversa";
+    } else if (header.image_size != size ||
+               !section_fits(&header.rescuer_types, sizeof(rescuer_type_t), 1, size) ||
+               !section_fits(&header.twins, sizeof(rescuer_digital_twin_t), 1, size) ||
+               !section_fits(&header.emergency_types, sizeof(emergency_type_t), 1, size) ||
+               !section_fits(&header.requests, sizeof(rescuer_request_t), 0, size) ||
+               header.strings.offset > size || header.strings.count > size - header.strings.offset ||
+               header.strings.count == 0 || base[header.strings.offset + header.strings.count - 1] != '\0') {
+        reason = "sezioni non valide";
+    } else {
+        config_image_source_t current[CONFIG_IMAGE_SOURCES];
+        if (config_image_stamp(paths, current) != 0) {
+            reason = "file sorgente non leggibili";
+        } else {
+            for (size_t i = 0; i < CONFIG_IMAGE_SOURCES && !reason; i++) {
+                if (memcmp(&current[i], &header.sources[i], sizeof(current[i])) != 0) reason = "file sorgente modificati";
+            }
+        }
+    }
+    if (!reason && !image_relocate(base, &header)) reason = "riferimenti fuori dalle sezioni";
+    if (reason) {
+        LOG_WARN(FILE_PARSING, "CONFIG-IMAGE", "Immagine '%s' ignorata (%s): si usano i file di configurazione", image_path, reason);
+        munmap(base, size);
+        return -1;
+    }
+
+    image->base = base;
+    image->size = size;
+    image->rescuer_types = (rescuer_type_t*)(base + header.rescuer_types.offset);
+    image->rescuer_types_count = header.rescuer_types.count;
+    image->rescuer_twins = (rescuer_digital_twin_t*)(base + header.twins.offset);
+    image->rescuer_twins_count = header.twins.count;
+    image->emergency_types = (emergency_type_t*)(base + header.emergency_types.offset);
+    image->emergency_types_count = header.emergency_types.count;
+    LOG_FILE_PARSING("CONFIG-IMAGE", "Immagine '%s' caricata: %zu tipi di soccorritori, %zu gemelli, %zu tipi di emergenza",
+                     image_path, image->rescuer_types_count, image->rescuer_twins_count, image->emergency_types_count);
+    return 0;
+}
+
+static char* image_strdup(const config_image_t* image, uint64_t offset, bool* ok) {
+    if (offset == 0) return NULL;
+    char* copy = strdup((const char*)image->base + offset);
+    if (!copy) *ok = false;
+    return copy;
+}
+
+int config_image_environment(const config_image_t* image, environment_variable_t* env_vars) {
+    if (!image || !image->base || !env_vars) return -1;
+    config_image_header_t header;
+    memcpy(&header, image->base, sizeof(header));
+    // Gli scostamenti delle stringhe dell'ambiente si verificano come quelli dei tipi
+    char* fields[3] = { IMAGE_POINTER(char*, header.env.queue), IMAGE_POINTER(char*, header.env.metrics_socket), IMAGE_POINTER(char*, header.env.journal) };
+    for (size_t i = 0; i < 3; i++) {
+        if (!relocate_string((char*)image->base, &header, &fields[i])) return -1;
+    }
+
+    bool ok = true;
+    *env_vars = (environment_variable_t){
+        .queue = image_strdup(image, header.env.queue, &ok),
+        .height = header.env.height,
+        .width = header.env.width,
+        .dispatch_mode = (dispatch_mode_t)header.env.dispatch_mode,
+        .dispatch_window_ms = header.env.dispatch_window_ms,
+        .dispatch_batch_max = header.env.dispatch_batch_max,
+        .metrics_socket = image_strdup(image, header.env.metrics_socket, &ok),
+        .journal = image_strdup(image, header.env.journal, &ok),
+        .journal_sync_ms = header.env.journal_sync_ms,
+    };
+    if (!ok) {
+        free(env_vars->queue);
+        free(env_vars->metrics_socket);
+        free(env_vars->journal);
+        *env_vars = (environment_variable_t){ 0 };
+        return -1;
+    }
+    return 0;
+}
+
+void config_image_close(config_image_t* image) {
+    if (!image || !image->base) return;
+    munmap(image->base, image->size);
+    *image = (config_image_t){ 0 };
+}
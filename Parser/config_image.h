@@ -0,0 +1,63 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include "../Types/emergency_types.h"
+#include "../Types/rescuers.h"
+#include "parse_env.h"
+
+/*
+* Immagine binaria precompilata della configurazione (prodotta da confc).
+* Contiene tipi di soccorritori, gemelli digitali, tipi di emergenza con le loro richieste e variabili
+* d'ambiente già nel formato usato dal server: ogni array ha la stessa disposizione delle struct in memoria
+* e i campi puntatore contengono lo scostamento dall'inizio dell'immagine (0 = NULL).
+* Il server la mappa con mmap privata e si limita a sommare l'indirizzo base a quei campi (rilocazione),
+* senza parsing, senza un'allocazione per elemento e senza log per token.
+* L'immagine registra dimensione e mtime dei file sorgente: se uno è cambiato è considerata non aggiornata
+* e il server torna ai parser testuali.
+*/
+
+#define CONFIG_IMAGE_DEFAULT_PATH "./Data/config.img"
+#define CONFIG_IMAGE_VERSION 1
+#define CONFIG_IMAGE_SOURCES 3
+
+// File di configurazione da cui è compilata l'immagine
+typedef struct config_paths_t {
+    const char* environment;
+    const char* rescuers;
+    const char* emergencies;
+} config_paths_t;
+
+// Impronta di un file sorgente al momento della compilazione
+typedef struct config_image_source_t {
+    int64_t size;
+    int64_t mtime_sec;
+    int64_t mtime_nsec;
+} config_image_source_t;
+
+typedef struct config_image_t {
+    void* base;                         // Inizio della mappatura (NULL = nessuna immagine)
+    size_t size;
+
+    rescuer_type_t* rescuer_types;      // Terminato da un elemento con nome NULL, come nei parser
+    size_t rescuer_types_count;
+    rescuer_digital_twin_t* rescuer_twins;
+    size_t rescuer_twins_count;
+    emergency_type_t* emergency_types;
+    size_t emergency_types_count;
+} config_image_t;
+
+// Impronta dei file sorgente: va presa prima di leggerli, così una modifica durante la compilazione rende
+// l'immagine non aggiornata invece di nasconderla
+int config_image_stamp(const config_paths_t* paths, config_image_source_t stamps[CONFIG_IMAGE_SOURCES]);
+
+// Scrive l'immagine (file temporaneo + rename, un server in avvio vede la vecchia o la nuova)
+int config_image_write(const char* image_path, const config_image_source_t stamps[CONFIG_IMAGE_SOURCES],
+                       const environment_variable_t* env_vars, const rescuer_type_t* rescuer_types,
+                       const rescuer_digital_twin_t* rescuer_twins, size_t rescuer_twins_count,
+                       const emergency_type_t* emergency_types, size_t emergency_types_count);
+
+// Mappa e riloca l'immagine; -1 se manca, non è valida o non è aggiornata rispetto ai file in paths
+int config_image_load(config_image_t* image, const char* image_path, const config_paths_t* paths);
+// Copia le variabili d'ambiente dell'immagine (stringhe allocate con strdup, come parse_environment_variables)
+int config_image_environment(const config_image_t* image, environment_variable_t* env_vars);
+void config_image_close(config_image_t* image);
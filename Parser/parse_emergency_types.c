@@ -6,22 +6,20 @@
 #include "../Types/rescuers.h"
 #include "../logging.h"
 
-// Cerca il rescuer dato il suo nome nella lista di digital twins
-static rescuer_type_t* find_rescuer_type_by_name(const char* name, rescuer_type_t* types_list) {
-    LOG_SYSTEM("parse_emergency_types", "Ricerca del tipo di soccorritore: %s", name);
-    if (!name || !types_list) {
-        LOG_SYSTEM("parse_emergency_types", "Nome o lista di tipi di soccorritore non validi");
+// Cerca il tipo di soccorritore dato il suo nome tramite l'indice costruito sulla lista dei tipi
+static rescuer_type_t* find_rescuer_type_by_name(const char* name, const name_index_t* types_index, rescuer_type_t* types_list) {
+    LOG_DEBUG(SYSTEM, "parse_emergency_types", "Ricerca del tipo di soccorritore: %s", name);
+    if (!name || !types_index || !types_list) {
+        LOG_WARN(SYSTEM, "parse_emergency_types", "Nome o lista di tipi di soccorritore non validi");
         return NULL;
     }
 
-    for (size_t i = 0; types_list[i].rescuer_type_name; i++) {
-        if (strcmp(types_list[i].rescuer_type_name, name) == 0) {
-            LOG_SYSTEM("parse_emergency_types", "Tipo di soccorritore trovato: %s", name);
-            return &types_list[i];
-        }
+    int position = name_index_get(types_index, name);
+    if (position == NAME_INDEX_NOT_FOUND) {
+        LOG_WARN(SYSTEM, "parse_emergency_types", "Tipo di soccorritore non trovato: %s", name);
+        return NULL;
     }
-    LOG_SYSTEM("parse_emergency_types", "Tipo di soccorritore non trovato: %s", name);
-    return NULL;
+    return &types_list[position];
 }
 
 
@@ -33,7 +31,7 @@ int parse_emergency_type(const char* path,
 
     FILE* file = fopen(path, "r");
     if (!file) {
-        LOG_FILE_PARSING("PARSE-EMERGENCY-TYPES-ERROR", "Errore apertura file '%s'", path);
+        LOG_ERROR(FILE_PARSING, "PARSE-EMERGENCY-TYPES-ERROR", "Errore apertura file '%s'", path);
         perror("Errore apertura file");
         return -1;
     }
@@ -57,7 +55,7 @@ int parse_emergency_type(const char* path,
             // Trovata un'emergenza valida, rialloca l'array dei contatori
             rescuers_required_for_emergency = realloc(rescuers_required_for_emergency, (emergency_count + 1) * sizeof(size_t));
             if (!rescuers_required_for_emergency) {
-                LOG_FILE_PARSING("PARSE-EMERGENCY-TYPES-ERROR", "Errore realloc memoria per le emergenze '%s'", path);
+                LOG_ERROR(FILE_PARSING, "PARSE-EMERGENCY-TYPES-ERROR", "Errore realloc memoria per le emergenze '%s'", path);
                 perror("Errore realloc"); exit(1);
             }
             
@@ -86,7 +84,7 @@ int parse_emergency_type(const char* path,
     }
     
     if (emergency_count == 0) { 
-        LOG_FILE_PARSING("PARSE-EMERGENCY-TYPES-WARNING", "Nessun tipo di emergenza trovato in '%s'", path);
+        LOG_WARN(FILE_PARSING, "PARSE-EMERGENCY-TYPES-WARNING", "Nessun tipo di emergenza trovato in '%s'", path);
     }
 
     // -----------------------------------------------------------------
@@ -99,6 +97,19 @@ int parse_emergency_type(const char* path,
         perror("Errore calloc emergency_types"); exit(1);
     }
 
+    // Indice dei tipi di soccorritore per nome (a parità di nome vale la prima riga, come nella ricerca lineare)
+    size_t rescuer_types_count = 0;
+    while (all_rescuer_types && all_rescuer_types[rescuer_types_count].rescuer_type_name) {
+        rescuer_types_count++;
+    }
+    name_index_t rescuer_types_index;
+    if (name_index_init(&rescuer_types_index, rescuer_types_count) != 0) {
+        perror("Errore calloc indice dei tipi di soccorritore"); exit(1);
+    }
+    for (size_t t = 0; t < rescuer_types_count; t++) {
+        name_index_put(&rescuer_types_index, all_rescuer_types[t].rescuer_type_name, (int)t);
+    }
+
     // -----------------------------------------------------------------
     // --- PASSATA 2: Popolare ---
     // -----------------------------------------------------------------
@@ -139,7 +150,7 @@ int parse_emergency_type(const char* path,
                     rescuer_request_t* current_request = &(current_emergency->rescuer_requests[i]);
 
                     // --- COLLEGAMENTO CORRETTO ---
-                    current_request->type = find_rescuer_type_by_name(tok_name_resc, all_rescuer_types);
+                    current_request->type = find_rescuer_type_by_name(tok_name_resc, &rescuer_types_index, all_rescuer_types);
                     
                     if (current_request->type == NULL) {
                         fprintf(stderr, "ATTENZIONE: Tipo soccorritore '%s' non trovato!\n", tok_name_resc);
@@ -167,6 +178,7 @@ int parse_emergency_type(const char* path,
 
     free(line); // Libera il buffer di getline
     free(rescuers_required_for_emergency); // Libera l'array dei contatori
+    name_index_destroy(&rescuer_types_index);
     fclose(file);
     
     return emergency_count;
@@ -11,7 +11,7 @@ int parse_environment_variables(const char* path, environment_variable_t* env_va
 
     FILE* file = fopen(path, "r");
     if (!file) {
-        LOG_FILE_PARSING("PARSE-ENV-ERROR", "Errore apertura file '%s'", path);
+        LOG_ERROR(FILE_PARSING, "PARSE-ENV-ERROR", "Errore apertura file '%s'", path);
         perror("Errore nell'apertura del file");
         return -1;
     }
@@ -19,6 +19,15 @@ int parse_environment_variables(const char* path, environment_variable_t* env_va
     char* line = NULL;                                                                 // Puntatore per memorizzare la linea letta
     size_t len = 0;
 
+    // Valori predefiniti per le chiavi facoltative
+    env_vars->queue = NULL;
+    env_vars->dispatch_mode = DISPATCH_GREEDY;
+    env_vars->dispatch_window_ms = DISPATCH_DEFAULT_WINDOW_MS;
+    env_vars->dispatch_batch_max = DISPATCH_DEFAULT_BATCH_MAX;
+    env_vars->metrics_socket = NULL;
+    env_vars->journal = NULL;
+    env_vars->journal_sync_ms = -1;
+
     while (getline(&line, &len, file) != -1) {
         char* saveptr;
         char* tok_key = strtok_r(line, "=", &saveptr);
@@ -31,11 +40,31 @@ int parse_environment_variables(const char* path, environment_variable_t* env_va
                 env_vars->height = atoi(tok_value);
             } else if (strcmp(tok_key, "width") == 0) {                                // Assegna la larghezza dell'ambiente
                 env_vars->width = atoi(tok_value);
+            } else if (strcmp(tok_key, "dispatch") == 0) {                             // Strategia di assegnazione
+                if (strcmp(tok_value, "batch") == 0) {
+                    env_vars->dispatch_mode = DISPATCH_BATCH;
+                } else if (strcmp(tok_value, "greedy") == 0) {
+                    env_vars->dispatch_mode = DISPATCH_GREEDY;
+                } else {
+                    LOG_WARN(FILE_PARSING, "PARSE-ENV-WARNING", "Valore di 'dispatch' non valido: '%s', uso 'greedy'", tok_value);
+                }
+            } else if (strcmp(tok_key, "dispatch_window_ms") == 0) {                   // Finestra di raccolta del gruppo
+                env_vars->dispatch_window_ms = atoi(tok_value);
+            } else if (strcmp(tok_key, "dispatch_batch_max") == 0) {                   // Dimensione massima del gruppo
+                env_vars->dispatch_batch_max = atoi(tok_value);
+            } else if (strcmp(tok_key, "metrics_socket") == 0) {                       // Socket dell'endpoint delle metriche
+                free(env_vars->metrics_socket);
+                env_vars->metrics_socket = strdup(tok_value);
+            } else if (strcmp(tok_key, "journal") == 0) {                              // File del journal delle transizioni
+                free(env_vars->journal);
+                env_vars->journal = strdup(tok_value);
+            } else if (strcmp(tok_key, "journal_sync_ms") == 0) {                      // Finestra del group commit
+                env_vars->journal_sync_ms = atoi(tok_value);
             }
         }
     }
     if(env_vars->queue == NULL) {
-        LOG_FILE_PARSING("PARSE-ENV-WARNING", "'queue' non trovata in '%s'", path);
+        LOG_WARN(FILE_PARSING, "PARSE-ENV-WARNING", "'queue' non trovata in '%s'", path);
     } else {
         LOG_FILE_PARSING("PARSE-ENV", "Aggiunta la 'queue' con nome '%s' e dimensioni (%d, %d)", env_vars->queue, env_vars->width, env_vars->height);
     }
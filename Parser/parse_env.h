@@ -1,10 +1,25 @@
 #pragma once
 #include <stddef.h>
 
+// Strategia di assegnazione dei soccorritori
+typedef enum dispatch_mode_t {
+    DISPATCH_GREEDY = 0,    // Un'emergenza alla volta, soccorritore più vicino per ogni posto
+    DISPATCH_BATCH          // Emergenze raccolte in una finestra e assegnate insieme (costo minimo)
+} dispatch_mode_t;
+
+#define DISPATCH_DEFAULT_WINDOW_MS 100
+#define DISPATCH_DEFAULT_BATCH_MAX 32
+
 typedef struct environment_variable_t {
     char* queue;
     int height;
     int width;
+    dispatch_mode_t dispatch_mode;  // dispatch=greedy|batch
+    int dispatch_window_ms;         // dispatch_window_ms: attesa massima per completare un gruppo
+    int dispatch_batch_max;         // dispatch_batch_max: emergenze massime per gruppo
+    char* metrics_socket;           // metrics_socket: socket UNIX delle metriche (NULL = predefinito, "off" = disattivato)
+    char* journal;                  // journal: file del journal delle transizioni (NULL = predefinito, "off" = disattivato)
+    int journal_sync_ms;            // journal_sync_ms: finestra del group commit del journal (-1 = predefinita)
 } environment_variable_t;
 
 
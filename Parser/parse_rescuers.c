@@ -16,7 +16,7 @@ int parse_rescuer_type(const char* path, rescuer_type_t** rescuer_types, rescuer
     
     FILE* file = fopen(path, "r");
     if (!file) {
-        LOG_FILE_PARSING("PARSE-RESCUER-TYPES-ERROR", "Errore apertura file '%s'", path);
+        LOG_ERROR(FILE_PARSING, "PARSE-RESCUER-TYPES-ERROR", "Errore apertura file '%s'", path);
         perror("Errore nell'apertura del file");
         return -1;
     }
@@ -51,7 +51,7 @@ int parse_rescuer_type(const char* path, rescuer_type_t** rescuer_types, rescuer
 
     // Se il file è vuoto o malformato, esci
     if (type_count == 0) {
-        LOG_FILE_PARSING("PARSE-RESCUER-TYPES-WARNING", "Nessun tipo di soccorritore trovato in '%s'", path);
+        LOG_WARN(FILE_PARSING, "PARSE-RESCUER-TYPES-WARNING", "Nessun tipo di soccorritore trovato in '%s'", path);
         *rescuer_types = NULL;
         *out_rescuer_twins = NULL;
         free(line);
@@ -68,7 +68,7 @@ int parse_rescuer_type(const char* path, rescuer_type_t** rescuer_types, rescuer
     // Calloc serve per impostare a NULL tutti i campi iniziali, incluso il terminatore
     *rescuer_types = calloc(type_count + 1, sizeof(rescuer_type_t));
     if (!*rescuer_types) {
-        LOG_FILE_PARSING("PARSE-RESCUER-TYPES-ERROR", "Errore di allocazione memoria per i tipi di soccorritori in '%s'", path);
+        LOG_ERROR(FILE_PARSING, "PARSE-RESCUER-TYPES-ERROR", "Errore di allocazione memoria per i tipi di soccorritori in '%s'", path);
         perror("Errore di allocazione per rescuer_types");
         free(line);
         fclose(file);
@@ -78,7 +78,7 @@ int parse_rescuer_type(const char* path, rescuer_type_t** rescuer_types, rescuer
     // Alloca spazio per il numero esatto di "gemelli" + 1 per il terminatore NULL
     *out_rescuer_twins = calloc(total_twin_count + 1, sizeof(rescuer_digital_twin_t));
     if (!*out_rescuer_twins) {
-        LOG_FILE_PARSING("PARSE-RESCUER-TYPES-ERROR", "Errore di allocazione memoria per i gemelli digitali in '%s'", path);
+        LOG_ERROR(FILE_PARSING, "PARSE-RESCUER-TYPES-ERROR", "Errore di allocazione memoria per i gemelli digitali in '%s'", path);
         perror("Errore di allocazione per out_rescuer_twins");
         free(*rescuer_types); // Libera la memoria già allocata
         free(line);
@@ -96,6 +96,15 @@ int parse_rescuer_type(const char* path, rescuer_type_t** rescuer_types, rescuer
  
     size_t current_type_idx = 0; // Indice corrente per i tipi di soccorritori
     size_t current_twin_idx = 0; // Indice corrente per i gemelli digitali
+    int next_type_id = 0;        // Prossimo identificativo di tipo libero
+    name_index_t type_ids;       // Nome del tipo -> type_id già assegnato
+    if (name_index_init(&type_ids, type_count) != 0) {
+        free(*rescuer_types);
+        free(*out_rescuer_twins);
+        free(line);
+        fclose(file);
+        return -1;
+    }
  
     while ((read = getline(&line, &len, file)) != -1) {
         char* saveptr;
@@ -114,6 +123,13 @@ int parse_rescuer_type(const char* path, rescuer_type_t** rescuer_types, rescuer
              current_type_ptr->speed = atoi(tok_speed);
              current_type_ptr->x = atoi(tok_x);
              current_type_ptr->y = atoi(tok_y);
+
+             // Assegna l'identificativo di tipo: righe con lo stesso nome condividono lo stesso id
+             current_type_ptr->type_id = name_index_get(&type_ids, current_type_ptr->rescuer_type_name);
+             if (current_type_ptr->type_id == NAME_INDEX_NOT_FOUND) {
+                 current_type_ptr->type_id = next_type_id++;
+                 name_index_put(&type_ids, current_type_ptr->rescuer_type_name, current_type_ptr->type_id);
+             }
              
              // Gestisci i "gemelli"
              int num_twins_for_this_rescuer = atoi(tok_num);
@@ -145,6 +161,7 @@ int parse_rescuer_type(const char* path, rescuer_type_t** rescuer_types, rescuer
      // -----------------------------------------------------------------
  
      free(line); // Libera la memoria allocata da getline
+     name_index_destroy(&type_ids);
      fclose(file);
      
      return total_twin_count; // Restituisce il numero di digital twin creati
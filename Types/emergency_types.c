@@ -7,18 +7,34 @@
 
 // funzione per cercare un tipo di emergenza dato il suo nome
 emergency_type_t* find_emergency_type_by_name(const char* name, emergency_type_t* emergency_types) {
-    LOG_SYSTEM("emergency_types", "Ricerca del tipo di emergenza: %s", name);
+    LOG_DEBUG(SYSTEM, "emergency_types", "Ricerca del tipo di emergenza: %s", name);
     if (name == NULL || emergency_types == NULL) {
-        LOG_SYSTEM("emergency_types", "Nome o lista di tipi di emergenza non validi");
+        LOG_WARN(SYSTEM, "emergency_types", "Nome o lista di tipi di emergenza non validi");
         return NULL;
     }
 
     for (size_t i = 0; emergency_types[i].emergency_name != NULL; i++) {
         if (strcmp(emergency_types[i].emergency_name, name) == 0) {
-            LOG_SYSTEM("emergency_types", "Tipo di emergenza trovato: %s", name);
+            LOG_DEBUG(SYSTEM, "emergency_types", "Tipo di emergenza trovato: %s", name);
             return &emergency_types[i];
         }
     }
-    LOG_SYSTEM("emergency_types", "Tipo di emergenza non trovato: %s", name);
+    LOG_WARN(SYSTEM, "emergency_types", "Tipo di emergenza non trovato: %s", name);
     return NULL; // Non trovato
 }
+
+// Costruisce l'indice nome -> posizione nell'array dei tipi di emergenza (da fare una volta dopo il parsing)
+int emergency_type_index_build(name_index_t* index, emergency_type_t* emergency_types, size_t emergency_types_count) {
+    if (!index || !emergency_types) {
+        return -1;
+    }
+    if (name_index_init(index, emergency_types_count) != 0) {
+        return -1;
+    }
+    for (size_t i = 0; i < emergency_types_count && emergency_types[i].emergency_name != NULL; i++) {
+        if (!name_index_put(index, emergency_types[i].emergency_name, (int)i)) {
+            LOG_WARN(SYSTEM, "emergency_types", "Tipo di emergenza duplicato ignorato: %s", emergency_types[i].emergency_name);
+        }
+    }
+    return 0;
+}
@@ -1,6 +1,8 @@
 #pragma once
 #include <stddef.h>
+#include <stdint.h>
 #include "rescuers.h"
+#include "name_index.h"
 
 
 #define EMERGENCY_NAME_LENGTH 64
@@ -35,9 +37,12 @@ typedef enum emergency_status_t {
 
 typedef struct emergency_request_t {
     char emergency_name[EMERGENCY_NAME_LENGTH];
+    int type_id;        // Indice del tipo nell'array dei tipi di emergenza (-1 = da risolvere per nome)
     int x;
     int y;
     time_t timestamp;
+    uint64_t received_ns;   // Istanti monotoni di ricezione e validazione nel consumer (0 = non misurati)
+    uint64_t parsed_ns;
 } emergency_request_t;
 
 typedef struct emergency_t {
@@ -51,3 +56,4 @@ typedef struct emergency_t {
 } emergency_t;
 
 emergency_type_t* find_emergency_type_by_name(const char* name, emergency_type_t* emergency_types); 
+int emergency_type_index_build(name_index_t* index, emergency_type_t* emergency_types, size_t emergency_types_count);
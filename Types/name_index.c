@@ -0,0 +1,84 @@
+#include "name_index.h"
+#include "../logging.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// Hash FNV-1a a 32 bit
+static uint32_t name_hash(const char* key) {
+    uint32_t hash = 2166136261u;
+    for (const unsigned char* p = (const unsigned char*)key; *p; ++p) {
+        hash ^= *p;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Inizializza un indice vuoto dimensionato per expected_count chiavi (fattore di carico <= 0.5)
+int name_index_init(name_index_t* index, size_t expected_count) {
+    if (!index) return -1;
+    *index = (name_index_t){0};
+
+    size_t capacity = 8;
+    while (capacity < expected_count * 2) {
+        capacity *= 2;
+    }
+
+    index->keys = calloc(capacity, sizeof(const char*));
+    index->hashes = calloc(capacity, sizeof(uint32_t));
+    index->values = calloc(capacity, sizeof(int));
+    if (!index->keys || !index->hashes || !index->values) {
+        LOG_ERROR(SYSTEM, "name_index", "Errore di allocazione per l'indice dei nomi");
+        name_index_destroy(index);
+        return -1;
+    }
+    index->capacity = capacity;
+    return 0;
+}
+
+void name_index_destroy(name_index_t* index) {
+    if (!index) return;
+    free(index->keys);
+    free(index->hashes);
+    free(index->values);
+    *index = (name_index_t){0};
+}
+
+// Slot della chiave, oppure primo slot libero della sua sequenza di sondaggio
+static size_t name_index_slot(const name_index_t* index, const char* key, uint32_t hash) {
+    size_t mask = index->capacity - 1;
+    size_t slot = hash & mask;
+    while (index->keys[slot] != NULL) {
+        if (index->hashes[slot] == hash && strcmp(index->keys[slot], key) == 0) {
+            return slot;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+bool name_index_put(name_index_t* index, const char* key, int value) {
+    if (!index || !index->keys || !key) return false;
+    if ((index->count + 1) * 2 > index->capacity) {
+        LOG_ERROR(SYSTEM, "name_index", "Indice dei nomi pieno, chiave ignorata: %s", key);
+        return false; // L'indice è dimensionato in name_index_init
+    }
+
+    uint32_t hash = name_hash(key);
+    size_t slot = name_index_slot(index, key, hash);
+    if (index->keys[slot] != NULL) {
+        return false; // Chiave già presente: si mantiene il primo valore
+    }
+    index->keys[slot] = key;
+    index->hashes[slot] = hash;
+    index->values[slot] = value;
+    index->count++;
+    return true;
+}
+
+int name_index_get(const name_index_t* index, const char* key) {
+    if (!index || !index->keys || !key) return NAME_INDEX_NOT_FOUND;
+    uint32_t hash = name_hash(key);
+    size_t slot = name_index_slot(index, key, hash);
+    return index->keys[slot] != NULL ? index->values[slot] : NAME_INDEX_NOT_FOUND;
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+* Indice nome -> intero a indirizzamento aperto (sondaggio lineare, hash FNV-1a).
+* Si costruisce una volta dopo il parsing e da lì in poi è di sola lettura, quindi può essere
+* consultato da più thread senza lock. Le chiavi non vengono copiate: devono restare valide
+* per tutta la vita dell'indice (es. i nomi dei tipi allocati dal parser).
+*/
+typedef struct name_index_t {
+    const char** keys;      // NULL = slot libero
+    uint32_t* hashes;
+    int* values;
+    size_t capacity;        // Potenza di 2, almeno il doppio delle chiavi
+    size_t count;
+} name_index_t;
+
+#define NAME_INDEX_NOT_FOUND (-1)
+
+int name_index_init(name_index_t* index, size_t expected_count);
+void name_index_destroy(name_index_t* index);
+
+// Inserisce la chiave; se è già presente mantiene il valore esistente e restituisce false
+bool name_index_put(name_index_t* index, const char* key, int value);
+
+// Valore associato alla chiave o NAME_INDEX_NOT_FOUND
+int name_index_get(const name_index_t* index, const char* key);
@@ -6,6 +6,7 @@ typedef struct rescuer_type_t  {
     int speed; // cells per second
     int x; 
     int y;
+    int type_id; // indice compatto assegnato dal parser, uguale per tipi con lo stesso nome
 } rescuer_type_t;
 
 
@@ -13,11 +14,21 @@ typedef enum rescuer_status_t  {
     IDLE, EN_ROUTE_TO_SCENE, ON_SCENE, RETURNING_TO_BASE
 } rescuer_status_t;
 
+#define RESCUER_NO_INDEX ((size_t)-1)
+
+struct emergency_record_t;
+
 typedef struct rescuer_digital_twin_t {
     int id;
     int x;
     int y;
     rescuer_type_t* type;
     rescuer_status_t status;
+    int pool_cell;     // cella della griglia in cui si trova: IDLE del proprio tipo o dei sottraibili (-1 se nessuna)
+    size_t pool_index; // posizione all'interno della cella
+    size_t in_use_index;                      // posizione tra i soccorritori in uso (RESCUER_NO_INDEX se IDLE)
+    struct emergency_record_t* assigned_record; // emergenza a cui è assegnato (NULL se nessuna)
+    size_t assigned_index;                    // posizione nell'array assigned_rescuers del record
+    int steal_bucket;  // gruppo (tipo, priorità della vittima) nell'indice dei sottraibili (-1 se assente)
 } rescuer_digital_twin_t;
  
\ No newline at end of file